@@ -4,60 +4,365 @@ using namespace std;
 const string DATA_FILE = "campus_data.txt";
 const string BACKUP_FILE = "campus_backup.txt";
 const string ADMIN_FILE = "admin.txt";
+const bool REORDER_ON_LOAD = true; // Renumber locations for memory locality after every load
+const int ROUTE_CACHE_CAPACITY = 256; // findPath results kept between campus state changes
+
+// NameTable -> interns location names into a few contiguous chunks; returned pointers stay valid until clear()
+class NameTable {
+private:
+    vector<unique_ptr<char[]>> chunks;
+    size_t chunkSize = 0, used = 0;
+    size_t reservedBytes = 0;
+    vector<const char*> slots; // Open-addressing index over interned names
+    size_t count = 0;
+
+    static size_t hashName(const char* s, size_t len) {
+        size_t h = 14695981039346656037ULL; // FNV-1a
+        for (size_t i = 0; i < len; i++) h = (h ^ static_cast<unsigned char>(s[i])) * 1099511628211ULL;
+        return h;
+    }
+
+    size_t findSlot(const char* s, size_t len) const {
+        size_t mask = slots.size() - 1;
+        size_t i = hashName(s, len) & mask;
+        while (slots[i] && (strncmp(slots[i], s, len) != 0 || slots[i][len] != '\0')) i = (i + 1) & mask;
+        return i;
+    }
+
+    const char* store(const char* s, size_t len) {
+        if (chunks.empty() || used + len + 1 > chunkSize) {
+            // Chunks double in size so a map of N names needs O(log N) allocations
+            chunkSize = max(chunkSize * 2, max<size_t>(256, len + 1));
+            chunks.emplace_back(new char[chunkSize]);
+            reservedBytes += chunkSize;
+            used = 0;
+        }
+        char* dest = chunks.back().get() + used;
+        memcpy(dest, s, len);
+        dest[len] = '\0';
+        used += len + 1;
+        return dest;
+    }
+
+public:
+    const char* intern(const char* s, size_t len) {
+        if ((count + 1) * 2 > slots.size()) {
+            vector<const char*> old(max<size_t>(16, slots.size() * 2), nullptr);
+            old.swap(slots);
+            for (const char* name : old) {
+                if (name) slots[findSlot(name, strlen(name))] = name;
+            }
+        }
+        size_t i = findSlot(s, len);
+        if (!slots[i]) {
+            slots[i] = store(s, len);
+            count++;
+        }
+        return slots[i];
+    }
+
+    const char* intern(const char* s) { return intern(s, strlen(s)); }
+
+    void clear() {
+        chunks.clear();
+        slots.clear();
+        chunkSize = used = reservedBytes = count = 0;
+    }
+
+    size_t memoryBytes() const { return reservedBytes + slots.capacity() * sizeof(const char*); }
+
+    int blockCount() const { return chunks.size() + (chunks.capacity() ? 1 : 0) + (slots.capacity() ? 1 : 0); }
+};
 
 // Location class -> Informations of every Location
 class Location {
 public:
     int id;
-    string name;
+    const char* name; // Interned by the owning CampusMap
     int importance; // 1 - 10
     int cleaningFrequency; // Preffered Days between cleanings
     int visitPriority; // Base priority 1-10
     int lastCleaned; // Days since last cleaned
     double cleanlinessStatus; // 0-100%
 
-    Location(int id, string name, int importance, int cleaningFrequency, 
+    Location(int id, const char* name, int importance, int cleaningFrequency, 
             int visitPriority, double cleanlinessStatus)
         : id(id), name(name), importance(importance), cleaningFrequency(cleaningFrequency),
           visitPriority(visitPriority), lastCleaned(0), cleanlinessStatus(cleanlinessStatus) {}
 };
 
+// Edge attribute storage -> compile with -DCAMPUS_FLOAT_EDGES or -DCAMPUS_QUANTISED_EDGES to shrink Path
+#if defined(CAMPUS_QUANTISED_EDGES)
+// Fixed point with two decimals, covering 0.00 - 655.35. Values it cannot hold exactly throw
+// instead of being clamped or rounded, so loadFromFile rejects the line and nothing altered is saved.
+class EdgeAttr {
+private:
+    uint16_t raw;
+
+    static uint16_t quantise(double value) {
+        double scaled = value * 100.0;
+        ostringstream error;
+        error << "edge value " << value;
+        if (!(scaled >= 0.0 && scaled <= 65535.0)) {
+            error << " outside 0 - 655.35";
+            throw out_of_range(error.str());
+        }
+        long long rounded = llround(scaled);
+        if (fabs(scaled - rounded) > 1e-6) {
+            error << " has more than two decimals";
+            throw invalid_argument(error.str());
+        }
+        return static_cast<uint16_t>(rounded);
+    }
+
+public:
+    EdgeAttr(double value = 0.0) : raw(quantise(value)) {}
+
+    operator double() const { return raw / 100.0; }
+};
+#elif defined(CAMPUS_FLOAT_EDGES)
+typedef float EdgeAttr;
+#else
+typedef double EdgeAttr;
+#endif
+
 // Path class -> representing connections between locations
 class Path {
 public:
     int from, to;
-    double distance;
-    double travelTime;
-    double difficulty;  // Factor representing road condition
+    EdgeAttr distance;
+    EdgeAttr travelTime;
+    EdgeAttr difficulty;  // Factor representing road condition
 
     Path(int from, int to, double distance, double travelTime = 1.0, double difficulty = 1.0)
         : from(from), to(to), distance(distance), travelTime(travelTime), difficulty(difficulty) {}
 };
 
+// PathArena -> every path in one contiguous block, grouped by start node (CSR layout)
+class PathArena {
+private:
+    vector<Path> paths;
+    vector<int> offsets = {0}; // Paths of node i are paths[offsets[i]] .. paths[offsets[i + 1] - 1]
+
+public:
+    struct Range {
+        const Path* first;
+        const Path* last;
+        const Path* begin() const { return first; }
+        const Path* end() const { return last; }
+        int size() const { return last - first; }
+        bool empty() const { return first == last; }
+    };
+
+    int size() const { return offsets.size() - 1; }
+
+    Range operator[](int node) const {
+        const Path* base = paths.data();
+        return {base + offsets[node], base + offsets[node + 1]};
+    }
+
+    const vector<Path>& allPaths() const { return paths; }
+
+    void clear() {
+        paths.clear();
+        paths.shrink_to_fit();
+        offsets.assign(1, 0);
+    }
+
+    // Replaces the contents; a counting sort keeps each node's paths in their given order
+    void assign(const vector<Path>& edges, int nodeCount) {
+        for (const auto& p : edges) nodeCount = max(nodeCount, p.from + 1);
+        offsets.assign(nodeCount + 1, 0);
+        for (const auto& p : edges) offsets[p.from + 1]++;
+        for (int i = 0; i < nodeCount; i++) offsets[i + 1] += offsets[i];
+
+        vector<int> cursor(offsets.begin(), offsets.end() - 1);
+        paths.clear();
+        paths.reserve(edges.size());
+        paths.insert(paths.end(), edges.begin(), edges.end());
+        for (const auto& p : edges) paths[cursor[p.from]++] = p;
+    }
+
+    // Extends the node range with nodes that have no paths yet
+    void growTo(int nodeCount) {
+        while (size() < nodeCount) offsets.push_back(offsets.back());
+    }
+
+    // Single insertion shifts the later paths; meant for occasional edits after a bulk assign().
+    // Grows the node range to cover both endpoints so searches can index `to` safely.
+    void insert(const Path& p) {
+        growTo(max(p.from, p.to) + 1);
+        paths.insert(paths.begin() + offsets[p.from + 1], p);
+        for (int i = p.from + 1; i < offsets.size(); i++) offsets[i]++;
+    }
+
+    size_t memoryBytes() const { return paths.capacity() * sizeof(Path) + offsets.capacity() * sizeof(int); }
+
+    int blockCount() const { return (paths.capacity() ? 1 : 0) + (offsets.capacity() ? 1 : 0); }
+};
+
 // CampusMap class -> manage locations and paths
 class CampusMap {
 private:
-    vector<Location> locations;
-    vector<vector<Path>> adjacencyList;
-    unordered_map<int, int> visitCounts;
+    vector<Location> locations; // Sorted by internal id, so searches touch them in the same order as their paths
+    vector<int> locationIndex; // Internal id -> position in locations, -1 for ids that only appear in paths
+    vector<int> listingOrder; // Internal ids of the locations in the order they were added, for output and saving
+    NameTable names;
+    PathArena adjacencyList; // Indexed by internal id
+    vector<int> visitCounts; // Indexed by internal id
+    vector<int> externalIds; // Internal id -> location id
+    unordered_map<int, int> internalIds; // Location id -> internal id; internal ids stay dense whatever ids the file uses
+    bool reorderOnLoad = false;
+    atomic<uint64_t> stateVersion{0}; // Bumped by every mutation, tags cached routes
+    uint64_t topologyVersion = 0; // Bumped when locations or paths are added or reloaded
+
+    // Internal id for a location id, extending the numbering, visit counts and path arena for new ids;
+    // -1 for negative ids. Every internal id is therefore a valid index into the adjacency list.
+    int internalSlot(int id) {
+        if (id < 0) return -1;
+        int index = toInternal(id);
+        if (index < 0) {
+            index = externalIds.size();
+            externalIds.push_back(id);
+            internalIds[id] = index;
+        }
+        if (index >= visitCounts.size()) visitCounts.resize(index + 1, 0);
+        if (index >= locationIndex.size()) locationIndex.resize(index + 1, -1);
+        adjacencyList.growTo(index + 1);
+        return index;
+    }
+
+    // Appends a location whose id is not in the map yet. Returns false when its id was already
+    // numbered by a path, so locations need sortLocations() to be in internal id order again.
+    bool storeLocation(const Location& loc) {
+        int index = internalSlot(loc.id);
+        if (locationIndex[index] >= 0) throw invalid_argument("duplicate location id");
+        bool inOrder = locations.empty() || toInternal(locations.back().id) < index;
+        listingOrder.push_back(index);
+        locationIndex[index] = locations.size();
+        locations.push_back(loc);
+        return inOrder;
+    }
+
+    void sortLocations() {
+        sort(locations.begin(), locations.end(), [this](const Location& a, const Location& b) {
+            return toInternal(a.id) < toInternal(b.id);
+        });
+        for (int i = 0; i < locations.size(); i++) locationIndex[toInternal(locations[i].id)] = i;
+    }
+
+    const Location* locationAt(int index) const {
+        int position = locationIndex[index];
+        return position < 0 ? nullptr : &locations[position];
+    }
 
 public:
     CampusMap() {}
 
+    // Data file parsers, shared with the streaming loader of ShardedCampusMap.
+    // The number parsers throw like stoi/stod so bad lines are reported the same way.
+    static int parseInt(const char* field) {
+        char* end;
+        errno = 0;
+        long value = strtol(field, &end, 10);
+        if (end == field) throw invalid_argument("parseInt");
+        if (errno == ERANGE || value < INT_MIN || value > INT_MAX) throw out_of_range("parseInt");
+        return static_cast<int>(value);
+    }
+
+    static double parseDouble(const char* field) {
+        char* end;
+        errno = 0;
+        double value = strtod(field, &end);
+        if (end == field) throw invalid_argument("parseDouble");
+        if (errno == ERANGE) throw out_of_range("parseDouble");
+        return value;
+    }
+
+    // Splits a line at commas without copying; fields point into `text`.
+    // Returns the field count, or -1 when the line has more than maxFields fields.
+    static int splitFields(const char* text, const char** fields, int maxFields) {
+        int fieldCount = 0;
+        fields[fieldCount++] = text;
+        for (const char* c = text; *c; c++) {
+            if (*c != ',') continue;
+            if (fieldCount == maxFields) return -1;
+            fields[fieldCount++] = c + 1;
+        }
+        if (fieldCount > 1 && *fields[fieldCount - 1] == '\0') fieldCount--; // Trailing comma
+        return fieldCount;
+    }
+
+    // The 8 fields of a "# Locations" line; `name` replaces the name field, visits go to `visits`
+    static Location parseLocation(const char* const* fields, const char* name, int& visits) {
+        Location loc(parseInt(fields[0]), name, parseInt(fields[2]), 
+                     parseInt(fields[3]), parseInt(fields[4]), parseDouble(fields[5]));
+        loc.lastCleaned = parseInt(fields[6]);
+        visits = parseInt(fields[7]);
+        if (loc.id < 0) throw out_of_range("negative location id");
+        return loc;
+    }
+
+    // The 5 fields of a "# Paths" line, with location ids as written in the file
+    static Path parsePath(const char* const* fields) {
+        int from = parseInt(fields[0]);
+        Path p(from, parseInt(fields[1]), parseDouble(fields[2]), 
+               parseDouble(fields[3]), parseDouble(fields[4]));
+        if (p.from < 0 || p.to < 0) throw out_of_range("negative location id");
+        return p;
+    }
+
+    void setReorderOnLoad(bool enabled) { reorderOnLoad = enabled; }
+
+    // Changes whenever locations, paths, cleanliness or visit counts change through this class.
+    // Edits made through the Location* returned by getLocationById/getLocationByName are not tracked.
+    uint64_t getStateVersion() const { return stateVersion.load(); }
+
+    // Changes only when the set of locations or paths changes, not with cleanliness or visits
+    uint64_t getTopologyVersion() const { return topologyVersion; }
+
+    // -1 for ids that are not part of the map
+    int toInternal(int id) const {
+        auto it = internalIds.find(id);
+        return it == internalIds.end() ? -1 : it->second;
+    }
+
+    int toExternal(int index) const {
+        return externalIds[index];
+    }
+
     void addLocation(Location loc) {
-        locations.push_back(loc);
-        visitCounts[loc.id] = 0;
+        if (loc.id < 0) {
+            cerr << "Invalid location id: " << loc.id << endl;
+            return;
+        }
+        if (getLocationById(loc.id)) {
+            cerr << "Duplicate location id: " << loc.id << endl;
+            return;
+        }
+        loc.name = names.intern(loc.name);
+        if (!storeLocation(loc)) sortLocations();
+        visitCounts[internalSlot(loc.id)] = 0;
+        stateVersion++;
+        topologyVersion++;
     }
 
-    void addPath(Path p) { adjacencyList[p.from].push_back(p); }
+    void addPath(Path p) {
+        if (p.from < 0 || p.to < 0) {
+            cerr << "Invalid path endpoints: " << p.from << " -> " << p.to << endl;
+            return;
+        }
+        p.from = internalSlot(p.from);
+        p.to = internalSlot(p.to);
+        adjacencyList.insert(p);
+        stateVersion++;
+        topologyVersion++;
+    }
 
     Location* getLocationById(int id) {
-        for (auto &loc : locations) {
-            if (loc.id == id) {
-                return &loc;
-            }
-        }
-        return nullptr;
+        int index = toInternal(id);
+        if (index < 0 || locationIndex[index] < 0) return nullptr;
+        return &locations[locationIndex[index]];
     }
 
     Location* getLocationByName(const string& name) {
@@ -76,47 +381,60 @@ public:
             double decayRate = 100.0 / (loc.cleaningFrequency * 2); // % loss per day
             loc.cleanlinessStatus = max(0.0, loc.cleanlinessStatus - (days * decayRate));
         }
+        stateVersion++;
     }
 
     void cleanLocation(int locId) {
-        for (auto &loc : locations) {
-            if (loc.id == locId) {
-                loc.lastCleaned = 0;
-                loc.cleanlinessStatus = 100.0;
-                visitCounts[locId]++;
-                break;
-            }
-        }
+        Location* loc = getLocationById(locId);
+        if (!loc) return;
+        loc->lastCleaned = 0;
+        loc->cleanlinessStatus = 100.0;
+        visitCounts[toInternal(locId)]++;
+        stateVersion++;
     }
 
     double calculateDynamicPriority(int locId) {
-        for (const auto &loc : locations) {
-            if (loc.id == locId) {
-                // Calculate priority based on multiple factors
-                double timeFactorNormalized = min(1.0, static_cast<double>(loc.lastCleaned) / loc.cleaningFrequency);
-                if (loc.lastCleaned < loc.cleaningFrequency) timeFactorNormalized *= 0.2; // Penalize recently cleaned locations
-                
-                double priority = (loc.importance * 0.3) + 
-                                 ((100 - loc.cleanlinessStatus) * 0.4) + 
-                                 (loc.visitPriority * 0.1) + 
-                                 (timeFactorNormalized * 0.2);
-                return priority;
-            }
-        }
-        return 0.0;
+        int index = toInternal(locId);
+        return index < 0 ? 0.0 : priorityAt(index);
     }
 
-    const vector<vector<Path>>& getAdjacencyList() const {
+    // Same as calculateDynamicPriority/getVisitCount, for callers that already hold an internal id
+    double priorityAt(int index) const {
+        const Location* loc = locationAt(index);
+        if (!loc) return 0.0;
+
+        // Calculate priority based on multiple factors
+        double timeFactorNormalized = min(1.0, static_cast<double>(loc->lastCleaned) / loc->cleaningFrequency);
+        if (loc->lastCleaned < loc->cleaningFrequency) timeFactorNormalized *= 0.2; // Penalize recently cleaned locations
+        
+        double priority = (loc->importance * 0.3) + 
+                         ((100 - loc->cleanlinessStatus) * 0.4) + 
+                         (loc->visitPriority * 0.1) + 
+                         (timeFactorNormalized * 0.2);
+        return priority;
+    }
+
+    int visitCountAt(int index) const {
+        return visitCounts[index];
+    }
+
+    // Indexed by internal id; map with toExternal() before showing or storing ids
+    const PathArena& getAdjacencyList() const {
         return adjacencyList;
     }
 
-    const vector<Location>& getLocations() const {
-        return locations;
+    // Copies of the locations in the order they were added
+    vector<Location> getLocations() const {
+        vector<Location> listed;
+        listed.reserve(listingOrder.size());
+        for (int index : listingOrder) listed.push_back(*locationAt(index));
+        return listed;
     }
 
     int getVisitCount(int locId) const {
-        if (visitCounts.find(locId) != visitCounts.end()) {
-            return visitCounts.at(locId);
+        int index = toInternal(locId);
+        if (index >= 0 && index < visitCounts.size()) {
+            return visitCounts[index];
         }
         return 0;
     }
@@ -131,13 +449,14 @@ public:
     
         cout << string(87, '-') << "\n";  
     
-        for (const auto &loc : locations) {
-            double priority = const_cast<CampusMap*>(this)->calculateDynamicPriority(loc.id);
+        for (int index : listingOrder) {
+            const Location& loc = *locationAt(index);
+            double priority = priorityAt(index);
             cout << setw(30) << left << loc.name 
                  << setw(9) << right << fixed << setprecision(2) << loc.cleanlinessStatus << " %"  
                  << setw(13) << right << loc.lastCleaned << " days"  
                  << setw(14) << right << fixed << setprecision(2) << priority
-                 << setw(10) << right << visitCounts.at(loc.id) << "\n";
+                 << setw(10) << right << visitCountAt(index) << "\n";
         }
         cout << "\n";
     }
@@ -152,7 +471,8 @@ public:
 
         // Save locations
         outFile << "# Locations\n";
-        for (const auto& loc : locations) {
+        for (int index : listingOrder) {
+            const Location& loc = *locationAt(index);
             outFile << loc.id << ","
                     << loc.name << ","
                     << loc.importance << ","
@@ -160,15 +480,19 @@ public:
                     << loc.visitPriority << ","
                     << loc.cleanlinessStatus << ","
                     << loc.lastCleaned << ","
-                    << visitCounts[loc.id] << "\n";
+                    << visitCountAt(index) << "\n";
         }
 
-        // Save paths
+        // Save paths in location id order, whatever the internal numbering
+        vector<int> order(adjacencyList.size());
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [this](int a, int b) { return toExternal(a) < toExternal(b); });
+
         outFile << "# Paths\n";
-        for (int from = 0; from < adjacencyList.size(); ++from) {
+        for (int from : order) {
             for (const auto& path : adjacencyList[from]) {
-                outFile << path.from << ","
-                        << path.to << ","
+                outFile << toExternal(path.from) << ","
+                        << toExternal(path.to) << ","
                         << path.distance << ","
                         << path.travelTime << ","
                         << path.difficulty << "\n";
@@ -186,11 +510,19 @@ public:
             return false;
         }
         locations.clear();
+        locationIndex.clear();
+        listingOrder.clear();
+        names.clear();
         visitCounts.clear();
         adjacencyList.clear();
+        externalIds.clear();
+        internalIds.clear();
         
         string line;
         string currentSection;
+        vector<Path> paths;
+        bool locationsSorted = true;
+        const char* fields[8];
         while (getline(inFile, line)) {
             if (line.empty()) continue;
             // Check section headers
@@ -199,28 +531,25 @@ public:
                 continue;
             }
 
-            stringstream ss(line);
-            string token;
-            vector<string> tokens;
-            while (getline(ss, token, ',')) tokens.push_back(token);
+            // Fields point into the line buffer, which getline reuses for every line
+            int fieldCount = splitFields(line.c_str(), fields, 8);
             
             try {
                 // Process locations
-                if (currentSection == "# Locations" && tokens.size() == 8) {
-                    Location loc(stoi(tokens[0]), tokens[1], stoi(tokens[2]), 
-                                 stoi(tokens[3]), stoi(tokens[4]), stod(tokens[5]));
-                    loc.lastCleaned = stoi(tokens[6]);
-                    locations.push_back(loc);
-                    visitCounts[loc.id] = stoi(tokens[7]);
+                if (currentSection == "# Locations" && fieldCount == 8) {
+                    const char* name = names.intern(fields[1], fields[2] - fields[1] - 1);
+                    int visits;
+                    Location loc = parseLocation(fields, name, visits);
+                    if (!storeLocation(loc)) locationsSorted = false;
+                    visitCounts[internalSlot(loc.id)] = visits;
                 } 
                 // Process paths
-                else if (currentSection == "# Paths" && tokens.size() == 5) {
-                    int from = stoi(tokens[0]);
-                    Path p(from, stoi(tokens[1]), stod(tokens[2]), 
-                           stod(tokens[3]), stod(tokens[4]));
+                else if (currentSection == "# Paths" && fieldCount == 5) {
+                    Path p = parsePath(fields);
                     
-                    if (from >= adjacencyList.size()) adjacencyList.resize(from + 1);
-                    adjacencyList[from].push_back(p);
+                    p.from = internalSlot(p.from);
+                    p.to = internalSlot(p.to);
+                    paths.push_back(p);
                 }
                 else  cerr << "Invalid format in " << currentSection << ": " << line << endl;
             }
@@ -228,20 +557,263 @@ public:
         }
         
         inFile.close();
+        if (!locationsSorted) sortLocations();
+        adjacencyList.assign(paths, externalIds.size());
+        stateVersion++;
+        topologyVersion++;
+        if (reorderOnLoad) reorderForLocality();
+        printMemoryFootprint();
+        return true;
+    }
+
+    // Heap bytes and blocks held by the map's storage
+    void printMemoryFootprint() const {
+        size_t locationBytes = locations.capacity() * sizeof(Location);
+        // The id hash map holds one node per id plus its bucket array
+        size_t indexBytes = (visitCounts.capacity() + externalIds.capacity() + locationIndex.capacity() +
+                             listingOrder.capacity()) * sizeof(int) +
+                            internalIds.size() * (sizeof(pair<const int, int>) + 2 * sizeof(void*)) +
+                            internalIds.bucket_count() * sizeof(void*);
+        size_t totalBytes = locationBytes + names.memoryBytes() + adjacencyList.memoryBytes() + indexBytes;
+        int blocks = (locations.capacity() ? 1 : 0) + names.blockCount() + adjacencyList.blockCount() +
+                     (visitCounts.capacity() ? 1 : 0) + (externalIds.capacity() ? 1 : 0) +
+                     (locationIndex.capacity() ? 1 : 0) + (listingOrder.capacity() ? 1 : 0) +
+                     internalIds.size() + (internalIds.bucket_count() ? 1 : 0);
+
+        cout << "Loaded " << locations.size() << " locations and " << adjacencyList.allPaths().size() << " paths: "
+             << totalBytes << " bytes in " << blocks << " allocations (locations " << locationBytes
+             << ", names " << names.memoryBytes() << ", paths " << adjacencyList.memoryBytes()
+             << ", indexes " << indexBytes << ")\n";
+    }
+
+    // Reverse Cuthill-McKee renumbering so that neighbouring locations get nearby internal ids
+    // and their adjacency lists sit close together in memory. Location ids seen through the
+    // public API, output and saved files are unchanged.
+    void reorderForLocality() {
+        int n = externalIds.size();
+        if (n == 0) return;
+
+        vector<vector<int>> neighbours(n);
+        for (int from = 0; from < adjacencyList.size(); ++from) {
+            for (const auto& path : adjacencyList[from]) {
+                neighbours[from].push_back(path.to);
+                neighbours[path.to].push_back(from);
+            }
+        }
+        for (auto& adj : neighbours) {
+            sort(adj.begin(), adj.end());
+            adj.erase(unique(adj.begin(), adj.end()), adj.end());
+        }
+        auto byDegree = [&neighbours](int a, int b) {
+            return neighbours[a].size() != neighbours[b].size() ? neighbours[a].size() < neighbours[b].size() : a < b;
+        };
+
+        // BFS from the lowest-degree unvisited node of each component, neighbours in degree order
+        vector<int> seeds(n);
+        iota(seeds.begin(), seeds.end(), 0);
+        sort(seeds.begin(), seeds.end(), byDegree);
+        vector<int> order;
+        vector<bool> visited(n, false);
+        for (int seed : seeds) {
+            if (visited[seed]) continue;
+            visited[seed] = true;
+            order.push_back(seed);
+            for (int head = order.size() - 1; head < order.size(); ++head) {
+                vector<int> next;
+                for (int v : neighbours[order[head]]) {
+                    if (!visited[v]) {
+                        visited[v] = true;
+                        next.push_back(v);
+                    }
+                }
+                sort(next.begin(), next.end(), byDegree);
+                order.insert(order.end(), next.begin(), next.end());
+            }
+        }
+
+        vector<int> newIndex(n);
+        for (int i = 0; i < n; i++) newIndex[order[i]] = n - 1 - i;
+
+        vector<Path> reordered;
+        reordered.reserve(adjacencyList.allPaths().size());
+        vector<int> newExternalIds(n), newVisitCounts(n, 0), newLocationIndex(n, -1);
+        for (int old = 0; old < n; old++) {
+            newExternalIds[newIndex[old]] = externalIds[old];
+            newVisitCounts[newIndex[old]] = visitCounts[old];
+            newLocationIndex[newIndex[old]] = locationIndex[old];
+            if (old >= adjacencyList.size()) continue;
+            for (auto path : adjacencyList[old]) {
+                path.from = newIndex[path.from];
+                path.to = newIndex[path.to];
+                reordered.push_back(path);
+            }
+        }
+
+        adjacencyList.assign(reordered, n);
+        externalIds.swap(newExternalIds);
+        visitCounts.swap(newVisitCounts);
+        locationIndex.swap(newLocationIndex);
+        for (int i = 0; i < n; i++) internalIds[externalIds[i]] = i;
+        for (int& index : listingOrder) index = newIndex[index];
+
+        // Lay the locations out in the new order too, so a search reads them alongside their paths
+        vector<Location> reorderedLocations;
+        reorderedLocations.reserve(locations.size());
+        for (int i = 0; i < n; i++) {
+            if (locationIndex[i] < 0) continue;
+            reorderedLocations.push_back(locations[locationIndex[i]]);
+            locationIndex[i] = reorderedLocations.size() - 1;
+        }
+        locations.swap(reorderedLocations);
+        stateVersion++;
+    }
+};
+
+// RouteKey -> identifies a findPath request: endpoints plus the finder's weight factors
+struct RouteKey {
+    int source, destination;
+    double alpha, beta, gamma, delta;
+
+    bool operator==(const RouteKey& other) const {
+        return source == other.source && destination == other.destination && alpha == other.alpha &&
+               beta == other.beta && gamma == other.gamma && delta == other.delta;
+    }
+};
+
+struct RouteKeyHash {
+    size_t operator()(const RouteKey& key) const {
+        size_t h = hash<int>()(key.source) * 31 + hash<int>()(key.destination);
+        for (double w : {key.alpha, key.beta, key.gamma, key.delta}) h = h * 31 + hash<double>()(w);
+        return h;
+    }
+};
+
+// RouteCache -> bounded LRU of routes tagged with the campus state version they were computed at.
+// Keys are spread over independently locked shards so concurrent callers rarely contend.
+class RouteCache {
+private:
+    struct Entry {
+        RouteKey key;
+        uint64_t version;
+        pair<vector<int>, double> route;
+    };
+
+    struct Shard {
+        mutex lock;
+        list<Entry> entries; // Most recently used first
+        unordered_map<RouteKey, list<Entry>::iterator, RouteKeyHash> index;
+    };
+
+    vector<unique_ptr<Shard>> shards;
+    size_t shardCapacity;
+    atomic<uint64_t> hits{0}, misses{0}, staleMisses{0}, evictions{0};
+
+    Shard& shardFor(const RouteKey& key) { return *shards[RouteKeyHash()(key) % shards.size()]; }
+
+public:
+    RouteCache(size_t capacity = ROUTE_CACHE_CAPACITY, int shardCount = 8) {
+        shardCount = max(1, shardCount);
+        for (int i = 0; i < shardCount; i++) shards.emplace_back(new Shard());
+        shardCapacity = max<size_t>(1, (capacity + shardCount - 1) / shardCount);
+    }
+
+    // Fills `route` on a hit. Entries from an older campus state count as misses and are dropped;
+    // entries newer than the caller's version are kept for up-to-date callers.
+    bool lookup(const RouteKey& key, uint64_t version, pair<vector<int>, double>& route) {
+        Shard& shard = shardFor(key);
+        lock_guard<mutex> guard(shard.lock);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            misses++;
+            return false;
+        }
+        if (it->second->version != version) {
+            if (it->second->version < version) {
+                shard.entries.erase(it->second);
+                shard.index.erase(it);
+                staleMisses++;
+            }
+            misses++;
+            return false;
+        }
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        route = it->second->route;
+        hits++;
         return true;
     }
+
+    void store(const RouteKey& key, uint64_t version, const pair<vector<int>, double>& route) {
+        Shard& shard = shardFor(key);
+        lock_guard<mutex> guard(shard.lock);
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            if (it->second->version > version) return; // Never replace a newer result with an older one
+            it->second->version = version;
+            it->second->route = route;
+            shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+            return;
+        }
+        if (shard.entries.size() >= shardCapacity) {
+            shard.index.erase(shard.entries.back().key);
+            shard.entries.pop_back();
+            evictions++;
+        }
+        shard.entries.push_front({key, version, route});
+        shard.index[key] = shard.entries.begin();
+    }
+
+    void clear() {
+        for (auto& shard : shards) {
+            lock_guard<mutex> guard(shard->lock);
+            shard->entries.clear();
+            shard->index.clear();
+        }
+    }
+
+    double hitRate() const {
+        uint64_t total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+    }
+
+    void printStats() const {
+        cout << "Route cache: " << hits << " hits, " << misses << " misses (" << staleMisses << " stale), "
+             << evictions << " evictions, hit rate " << fixed << setprecision(2) << (hitRate() * 100) << " %\n";
+    }
 };
 
 class ModifiedDijkstra {
     private:
         CampusMap* campus;
         double alpha, beta, gamma, delta; // Weight factors
+        RouteCache* cache;
     
     public:
         ModifiedDijkstra(CampusMap* c, double a = 0.6, double b = 0.3, double g = 0.1, double d = 0.2) 
-            : campus(c), alpha(a), beta(b), gamma(g), delta(d) {}
+            : campus(c), alpha(a), beta(b), gamma(g), delta(d), cache(nullptr) {}
+
+        // Reuse results for repeated requests until the campus state changes; nullptr disables caching
+        void setCache(RouteCache* c) { cache = c; }
     
+        // start/end and the returned path use location ids
         pair<vector<int>,double> findPath(int start, int end) {
+            if (!cache) return computePath(start, end);
+
+            RouteKey key = {start, end, alpha, beta, gamma, delta};
+            uint64_t version = campus->getStateVersion();
+            pair<vector<int>,double> route;
+            if (cache->lookup(key, version, route)) return route;
+
+            route = computePath(start, end);
+            cache->store(key, version, route);
+            return route;
+        }
+
+    private:
+        pair<vector<int>,double> computePath(int start, int end) {
+            start = campus->toInternal(start);
+            end = campus->toInternal(end);
+            if (start < 0 || end < 0) return {vector<int>(), INT_MAX};
+
             const auto& adjList = campus->getAdjacencyList();
             int n = adjList.size();
             vector<double> distances(n, INT_MAX);
@@ -262,8 +834,8 @@ class ModifiedDijkstra {
                     int to = edge.to;
                     
                     // Calculate weighted edge cost
-                    double priorityFactor = 1.0 - (campus->calculateDynamicPriority(to) / 100.0);
-                    double visitFactor = 1.0 + (campus->getVisitCount(to) * delta);
+                    double priorityFactor = 1.0 - (campus->priorityAt(to) / 100.0);
+                    double visitFactor = 1.0 + (campus->visitCountAt(to) * delta);
                     
                     double weight = (alpha * edge.distance) + 
                                    (beta * edge.difficulty) + 
@@ -289,13 +861,544 @@ class ModifiedDijkstra {
             }
             
             for (int at = end; at != -1; at = parents[at]) {
-                path.push_back(at);
+                path.push_back(campus->toExternal(at));
             }
             reverse(path.begin(), path.end());
             return {path,distances[end]};
         }
     };
-    
+
+// ParetoRoute -> one non-dominated route with its criteria totals
+struct ParetoRoute {
+    vector<int> path;
+    double distance;
+    double difficulty;
+    double travelTime;
+};
+
+// ParetoRouteFinder -> multi-criteria label-setting search over (distance, difficulty, travelTime)
+// Returns the whole Pareto front in one run instead of one route per alpha/beta/gamma combination
+class ParetoRouteFinder {
+private:
+    // Partial route ending at `node`, linked to its predecessor label by pool index
+    struct Label {
+        double distance, difficulty, travelTime;
+        int node;
+        int parent;
+        bool dominated;
+    };
+
+    CampusMap* campus;
+    vector<Label> pool; // Label storage reused across queries
+    vector<vector<int>> bags; // Non-dominated label indices per node
+
+    static bool dominates(double d1, double f1, double t1, double d2, double f2, double t2) {
+        return d1 <= d2 && f1 <= f2 && t1 <= t2;
+    }
+
+    bool isDominated(int node, double d, double f, double t) const {
+        for (int idx : bags[node]) {
+            const Label& other = pool[idx];
+            if (dominates(other.distance, other.difficulty, other.travelTime, d, f, t)) return true;
+        }
+        return false;
+    }
+
+    // Removes labels of the node's bag that the new label dominates, then adds it
+    void insertLabel(int idx) {
+        const Label& lbl = pool[idx];
+        auto& bag = bags[lbl.node];
+        size_t kept = 0;
+        for (int other : bag) {
+            Label& o = pool[other];
+            if (dominates(lbl.distance, lbl.difficulty, lbl.travelTime, o.distance, o.difficulty, o.travelTime)) {
+                o.dominated = true;
+            } else {
+                bag[kept++] = other;
+            }
+        }
+        bag.resize(kept);
+        bag.push_back(idx);
+    }
+
+public:
+    ParetoRouteFinder(CampusMap* c) : campus(c) {}
+
+    // Routes on the front are sorted by distance
+    vector<ParetoRoute> findParetoFront(int start, int end) {
+        start = campus->toInternal(start);
+        end = campus->toInternal(end);
+        if (start < 0 || end < 0) return vector<ParetoRoute>();
+
+        const auto& adjList = campus->getAdjacencyList();
+        int n = max(static_cast<int>(adjList.size()), max(start, end) + 1);
+        pool.clear();
+        bags.assign(n, vector<int>());
+
+        typedef tuple<double, double, double, int> Entry;
+        priority_queue<Entry, vector<Entry>, greater<>> pq;
+
+        pool.push_back({0.0, 0.0, 0.0, start, -1, false});
+        insertLabel(0);
+        pq.push(Entry(0.0, 0.0, 0.0, 0));
+
+        while (!pq.empty()) {
+            int idx = get<3>(pq.top());
+            pq.pop();
+
+            if (pool[idx].dominated) continue;
+            int node = pool[idx].node;
+            if (node == end || node >= static_cast<int>(adjList.size())) continue;
+
+            for (const auto& edge : adjList[node]) {
+                int to = edge.to;
+                if (to >= static_cast<int>(bags.size())) bags.resize(to + 1);
+
+                double d = pool[idx].distance + edge.distance;
+                double f = pool[idx].difficulty + edge.difficulty;
+                double t = pool[idx].travelTime + edge.travelTime;
+
+                // Prune against the labels at the neighbour and against routes already reaching the target
+                if (isDominated(to, d, f, t) || isDominated(end, d, f, t)) continue;
+
+                pool.push_back({d, f, t, to, idx, false});
+                int newIdx = static_cast<int>(pool.size()) - 1;
+                insertLabel(newIdx);
+                pq.push(Entry(d, f, t, newIdx));
+            }
+        }
+
+        vector<ParetoRoute> front;
+        for (int idx : bags[end]) {
+            ParetoRoute route;
+            route.distance = pool[idx].distance;
+            route.difficulty = pool[idx].difficulty;
+            route.travelTime = pool[idx].travelTime;
+            for (int at = idx; at != -1; at = pool[at].parent) {
+                route.path.push_back(campus->toExternal(pool[at].node));
+            }
+            reverse(route.path.begin(), route.path.end());
+            front.push_back(route);
+        }
+        sort(front.begin(), front.end(), [](const ParetoRoute& a, const ParetoRoute& b) {
+            return a.distance < b.distance;
+        });
+        return front;
+    }
+
+    // Picks the route minimising the weighted sum of the criteria; empty path if the front is empty
+    static ParetoRoute pickRoute(const vector<ParetoRoute>& front, double a, double b, double g) {
+        ParetoRoute best = {vector<int>(), INT_MAX, INT_MAX, INT_MAX};
+        double bestCost = INT_MAX;
+        for (const auto& route : front) {
+            double cost = (a * route.distance) + (b * route.difficulty) + (g * route.travelTime);
+            if (cost < bestCost) {
+                bestCost = cost;
+                best = route;
+            }
+        }
+        return best;
+    }
+};
+
+// Shard messages -> plain values so they can cross a process boundary unchanged
+// scanCampusFile -> streams a data file, calling onLocation(id) and onPath(path) for every line
+// CampusMap::loadFromFile would accept. Bad lines are skipped; loading the map reports them.
+template <class OnLocation, class OnPath>
+bool scanCampusFile(const string& filename, OnLocation onLocation, OnPath onPath) {
+    ifstream inFile(filename);
+    if (!inFile) return false;
+
+    string line;
+    string currentSection;
+    const char* fields[8];
+    while (getline(inFile, line)) {
+        if (line.empty()) continue;
+        if (line == "# Locations" || line == "# Paths") {
+            currentSection = line;
+            continue;
+        }
+
+        int fieldCount = CampusMap::splitFields(line.c_str(), fields, 8);
+        try {
+            if (currentSection == "# Locations" && fieldCount == 8) {
+                int visits;
+                onLocation(CampusMap::parseLocation(fields, "", visits).id);
+            }
+            else if (currentSection == "# Paths" && fieldCount == 5) {
+                onPath(CampusMap::parsePath(fields));
+            }
+        }
+        catch (const exception&) {}
+    }
+    return true;
+}
+
+struct ShardRequest {
+    enum Kind {
+        BOUNDARY,   // The shard's boundary nodes and the paths leaving its region
+        COSTS,      // Distances between `node` and every boundary node, plus `target` when it is local
+        ROUTE       // Locations on the shortest path from `node` to `target`
+    };
+
+    Kind kind;
+    int node;     // Global location id
+    int target;   // Global location id, -1 for none
+    bool reverse; // COSTS only: distances from the boundary nodes to `node` instead of from `node`
+};
+
+struct ShardReply {
+    vector<int> boundary;             // BOUNDARY: global ids
+    vector<Path> exits;               // BOUNDARY: paths to other regions, with global ids
+    unordered_map<int, double> costs; // COSTS: global id -> path distance
+    vector<int> route;                // ROUTE: global ids from `node` to `target`, empty if unreachable
+};
+
+// CampusShard -> one region of a partitioned campus, indexed by compact local ids
+class CampusShard {
+private:
+    vector<int> globalIds;
+    unordered_map<int, int> localIds;
+    vector<vector<pair<int, double>>> outEdges, inEdges; // (local id, distance)
+    vector<int> boundary; // Local ids with a path to or from another region
+    vector<Path> exits;
+
+    // Distances and search-tree parents from `source`; stops once `target` is settled when given
+    void search(int source, bool reverse, int target, vector<double>& distances, vector<int>& parents) const {
+        const auto& edges = reverse ? inEdges : outEdges;
+        int n = globalIds.size();
+        distances.assign(n, INT_MAX);
+        parents.assign(n, -1);
+        distances[source] = 0;
+
+        priority_queue<pair<double, int>, vector<pair<double, int>>, greater<>> pq;
+        pq.push({0, source});
+
+        while (!pq.empty()) {
+            double cost = pq.top().first;
+            int node = pq.top().second;
+            pq.pop();
+
+            if (cost > distances[node]) continue;
+            if (node == target) return;
+
+            for (const auto& edge : edges[node]) {
+                double newCost = distances[node] + edge.second;
+                if (newCost < distances[edge.first]) {
+                    distances[edge.first] = newCost;
+                    parents[edge.first] = node;
+                    pq.push({newCost, edge.first});
+                }
+            }
+        }
+    }
+
+public:
+    // Reads the region's locations and paths from the data file. Only this region is kept;
+    // paths crossing its border mark boundary nodes, and the outgoing ones are kept as exits.
+    void load(const string& filename, const vector<int>& region) {
+        for (int id : region) {
+            localIds[id] = globalIds.size();
+            globalIds.push_back(id);
+        }
+        outEdges.assign(globalIds.size(), vector<pair<int, double>>());
+        inEdges.assign(globalIds.size(), vector<pair<int, double>>());
+
+        vector<bool> isBoundary(globalIds.size(), false);
+        scanCampusFile(filename, [](int) {}, [&](const Path& p) {
+            auto from = localIds.find(p.from), to = localIds.find(p.to);
+            bool hasFrom = from != localIds.end(), hasTo = to != localIds.end();
+            if (hasFrom && hasTo) {
+                outEdges[from->second].push_back({to->second, p.distance});
+                inEdges[to->second].push_back({from->second, p.distance});
+            } else if (hasFrom) {
+                isBoundary[from->second] = true;
+                exits.push_back(p);
+            } else if (hasTo) {
+                isBoundary[to->second] = true;
+            }
+        });
+        for (int i = 0; i < globalIds.size(); i++) {
+            if (isBoundary[i]) boundary.push_back(i);
+        }
+    }
+
+    ShardReply handle(const ShardRequest& req) const {
+        ShardReply reply;
+        if (req.kind == ShardRequest::BOUNDARY) {
+            for (int b : boundary) reply.boundary.push_back(globalIds[b]);
+            reply.exits = exits;
+            return reply;
+        }
+
+        auto source = localIds.find(req.node);
+        if (source == localIds.end()) return reply;
+        auto target = localIds.find(req.target);
+        int targetLocal = target == localIds.end() ? -1 : target->second;
+
+        vector<double> distances;
+        vector<int> parents;
+        if (req.kind == ShardRequest::ROUTE) {
+            if (targetLocal < 0) return reply;
+            search(source->second, false, targetLocal, distances, parents);
+            if (distances[targetLocal] == INT_MAX) return reply;
+            for (int at = targetLocal; at != -1; at = parents[at]) reply.route.push_back(globalIds[at]);
+            reverse(reply.route.begin(), reply.route.end());
+            return reply;
+        }
+
+        search(source->second, req.reverse, -1, distances, parents);
+        for (int b : boundary) {
+            if (distances[b] != INT_MAX) reply.costs[globalIds[b]] = distances[b];
+        }
+        if (targetLocal >= 0 && distances[targetLocal] != INT_MAX) reply.costs[req.target] = distances[targetLocal];
+        return reply;
+    }
+};
+
+// ShardWorker -> loads and serves one shard on its own thread through a mailbox (local IPC stand-in)
+class ShardWorker {
+private:
+    CampusShard shard;
+    mutex mailboxMutex;
+    condition_variable mailboxReady;
+    deque<pair<ShardRequest, promise<ShardReply>>> mailbox;
+    bool stopping;
+    thread worker;
+
+    // Requests sent while the region is still loading wait in the mailbox
+    void serve(string filename, vector<int> region) {
+        shard.load(filename, region);
+        region.clear();
+        region.shrink_to_fit();
+        while (true) {
+            unique_lock<mutex> lock(mailboxMutex);
+            mailboxReady.wait(lock, [this] { return stopping || !mailbox.empty(); });
+            if (mailbox.empty()) return;
+            auto message = move(mailbox.front());
+            mailbox.pop_front();
+            lock.unlock();
+            message.second.set_value(shard.handle(message.first));
+        }
+    }
+
+public:
+    ShardWorker(const string& filename, vector<int> region)
+        : stopping(false), worker(&ShardWorker::serve, this, filename, move(region)) {}
+
+    ~ShardWorker() {
+        {
+            lock_guard<mutex> lock(mailboxMutex);
+            stopping = true;
+        }
+        mailboxReady.notify_one();
+        worker.join();
+    }
+
+    future<ShardReply> send(const ShardRequest& req) {
+        promise<ShardReply> reply;
+        future<ShardReply> result = reply.get_future();
+        {
+            lock_guard<mutex> lock(mailboxMutex);
+            mailbox.emplace_back(req, move(reply));
+        }
+        mailboxReady.notify_one();
+        return result;
+    }
+};
+
+// ShardedCampusMap -> campus split into regions; cross-region queries go through an overlay of boundary nodes
+class ShardedCampusMap {
+private:
+    struct OverlayEdge {
+        int to;
+        double cost;
+        int shard; // Shard that expands this shortcut into locations; -1 for a path between regions
+    };
+
+    unordered_map<int, int> shardOf;
+    vector<vector<int>> boundaryNodes; // Per shard
+    vector<unique_ptr<ShardWorker>> workers;
+    unordered_map<int, vector<OverlayEdge>> overlay;
+
+public:
+    // Streams the data file once for its topology and grows regions by BFS over the undirected
+    // graph: N / shardCount nodes per shard, the first N % shardCount shards taking one more.
+    // Each worker then reads its own region from the file; the topology is dropped afterwards.
+    ShardedCampusMap(const string& filename, int shardCount) {
+        vector<int> nodes;
+        unordered_map<int, vector<int>> neighbours;
+        scanCampusFile(filename, [&](int id) { nodes.push_back(id); }, [&](const Path& p) {
+            nodes.push_back(p.from);
+            nodes.push_back(p.to);
+            neighbours[p.from].push_back(p.to);
+            neighbours[p.to].push_back(p.from);
+        });
+        sort(nodes.begin(), nodes.end());
+        nodes.erase(unique(nodes.begin(), nodes.end()), nodes.end());
+        if (nodes.empty()) return;
+
+        shardCount = max(1, min(shardCount, static_cast<int>(nodes.size())));
+        vector<vector<int>> regions(shardCount);
+
+        // A node joins a shard when it leaves the queue, so the frontier of a full shard flows into the next one
+        int current = 0, filled = 0;
+        auto shardSize = [&](int shard) {
+            return static_cast<int>(nodes.size()) / shardCount + (shard < static_cast<int>(nodes.size()) % shardCount ? 1 : 0);
+        };
+        unordered_set<int> queued;
+        for (int seed : nodes) {
+            if (queued.count(seed)) continue;
+            queue<int> q;
+            q.push(seed);
+            queued.insert(seed);
+            while (!q.empty()) {
+                int node = q.front();
+                q.pop();
+                shardOf[node] = current;
+                regions[current].push_back(node);
+                if (++filled == shardSize(current) && current + 1 < shardCount) {
+                    current++;
+                    filled = 0;
+                }
+                for (int next : neighbours[node]) {
+                    if (queued.count(next)) continue;
+                    queued.insert(next);
+                    q.push(next);
+                }
+            }
+        }
+        neighbours.clear();
+        queued.clear();
+
+        for (auto& region : regions) workers.emplace_back(new ShardWorker(filename, move(region)));
+
+        // Boundary nodes and paths between regions, as reported by each shard
+        boundaryNodes.assign(shardCount, vector<int>());
+        vector<future<ShardReply>> descriptions;
+        for (auto& worker : workers) descriptions.push_back(worker->send({ShardRequest::BOUNDARY, -1, -1, false}));
+        for (int s = 0; s < shardCount; s++) {
+            ShardReply reply = descriptions[s].get();
+            boundaryNodes[s] = move(reply.boundary);
+            for (const auto& exit : reply.exits) overlay[exit.from].push_back({exit.to, exit.distance, -1});
+        }
+
+        // Shortcuts between boundary nodes of the same shard, costs only; routes are fetched when needed
+        vector<vector<future<ShardReply>>> costs(shardCount);
+        for (int s = 0; s < shardCount; s++) {
+            for (int b : boundaryNodes[s]) costs[s].push_back(workers[s]->send({ShardRequest::COSTS, b, -1, false}));
+        }
+        for (int s = 0; s < shardCount; s++) {
+            for (int i = 0; i < boundaryNodes[s].size(); i++) {
+                ShardReply reply = costs[s][i].get();
+                int from = boundaryNodes[s][i];
+                for (const auto& entry : reply.costs) {
+                    if (entry.first != from) overlay[from].push_back({entry.first, entry.second, s});
+                }
+            }
+        }
+    }
+
+    int getShardCount() const { return workers.size(); }
+
+    int getBoundaryCount() const {
+        int count = 0;
+        for (const auto& nodes : boundaryNodes) count += nodes.size();
+        return count;
+    }
+
+    // Shortest path by distance; empty path and INT_MAX cost when unreachable
+    pair<vector<int>, double> findPath(int start, int end) {
+        if (!shardOf.count(start) || !shardOf.count(end)) return {vector<int>(), INT_MAX};
+        int sourceShard = shardOf[start], targetShard = shardOf[end];
+
+        // Both shards work concurrently: costs out of the source region and into the target region
+        future<ShardReply> outgoing = workers[sourceShard]->send({ShardRequest::COSTS, start, end, false});
+        future<ShardReply> incoming = workers[targetShard]->send({ShardRequest::COSTS, end, -1, true});
+        ShardReply fromStart = outgoing.get();
+        ShardReply toEnd = incoming.get();
+
+        double best = INT_MAX;
+        int bestExit = -1; // Boundary node the route enters the target region through; -1 for a direct route
+        if (sourceShard == targetShard && fromStart.costs.count(end)) best = fromStart.costs[end];
+
+        // Dijkstra over the overlay, seeded with the source region's boundary costs
+        unordered_map<int, double> distances;
+        unordered_map<int, int> parents;
+        unordered_map<int, const OverlayEdge*> parentEdges;
+        priority_queue<pair<double, int>, vector<pair<double, int>>, greater<>> pq;
+        for (int b : boundaryNodes[sourceShard]) {
+            if (!fromStart.costs.count(b)) continue;
+            distances[b] = fromStart.costs[b];
+            parents[b] = -1;
+            pq.push({distances[b], b});
+        }
+
+        while (!pq.empty()) {
+            double cost = pq.top().first;
+            int node = pq.top().second;
+            pq.pop();
+
+            if (cost > distances[node]) continue;
+            if (cost >= best) break;
+
+            if (shardOf[node] == targetShard && toEnd.costs.count(node) && cost + toEnd.costs[node] < best) {
+                best = cost + toEnd.costs[node];
+                bestExit = node;
+            }
+
+            auto edges = overlay.find(node);
+            if (edges == overlay.end()) continue;
+            for (const auto& edge : edges->second) {
+                double newCost = cost + edge.cost;
+                if (!distances.count(edge.to) || newCost < distances[edge.to]) {
+                    distances[edge.to] = newCost;
+                    parents[edge.to] = node;
+                    parentEdges[edge.to] = &edge;
+                    pq.push({newCost, edge.to});
+                }
+            }
+        }
+
+        vector<int> path;
+        if (best == INT_MAX) return {path, best};
+
+        if (bestExit == -1) {
+            path = workers[sourceShard]->send({ShardRequest::ROUTE, start, end, false}).get().route;
+            return {path, best};
+        }
+
+        // Overlay chain back to the boundary node the route left the source region from
+        vector<const OverlayEdge*> chain;
+        int at = bestExit;
+        for (; parents[at] != -1; at = parents[at]) chain.push_back(parentEdges[at]);
+        reverse(chain.begin(), chain.end());
+
+        // Expand the route piece by piece, every shard working on its pieces concurrently
+        vector<future<ShardReply>> pieces;
+        pieces.push_back(workers[sourceShard]->send({ShardRequest::ROUTE, start, at, false}));
+        for (const auto* edge : chain) {
+            if (edge->shard >= 0) pieces.push_back(workers[edge->shard]->send({ShardRequest::ROUTE, at, edge->to, false}));
+            at = edge->to;
+        }
+        pieces.push_back(workers[targetShard]->send({ShardRequest::ROUTE, bestExit, end, false}));
+
+        path = pieces.front().get().route;
+        int piece = 1;
+        for (const auto* edge : chain) {
+            if (edge->shard < 0) {
+                path.push_back(edge->to);
+                continue;
+            }
+            vector<int> hops = pieces[piece++].get().route;
+            path.insert(path.end(), hops.begin() + 1, hops.end());
+        }
+        vector<int> tail = pieces.back().get().route;
+        path.insert(path.end(), tail.begin() + 1, tail.end());
+        return {path, best};
+    }
+};
+
     // Maintenance Scheduler for generating daily routes
     class MaintenanceScheduler {
     private:
@@ -440,14 +1543,25 @@ class ModifiedDijkstra {
 
 int main() {
     CampusMap campus;
+    campus.setReorderOnLoad(REORDER_ON_LOAD);
     bool loaded = campus.loadFromFile(BACKUP_FILE);
+    string campusFile = BACKUP_FILE; // File the map was last loaded from; the partitioned map reads it again
     if(!loaded){
         cout<<"Has no backup file. Reseting the campus map."<<endl;
         campus.loadFromFile(DATA_FILE);
+        campusFile = DATA_FILE;
     }
-    int numLocations = campus.getAdjacencyList().size();
+    // Location ids may be sparse, so a request is valid when the id is part of the loaded map
+    auto isKnownLocation = [&campus](int id) { return campus.toInternal(id) >= 0; };
 
+    RouteCache routeCache(ROUTE_CACHE_CAPACITY);
+    // Partitioned map for option 7, kept until the shard count or the campus topology changes
+    unique_ptr<ShardedCampusMap> shardedMap;
+    int shardedCount = 0;
+    uint64_t shardedTopology = 0;
     ModifiedDijkstra pathFinder(&campus);
+    pathFinder.setCache(&routeCache);
+    ParetoRouteFinder paretoFinder(&campus);
 
     bool running = true;
     while (running) {
@@ -457,6 +1571,8 @@ int main() {
         cout << "3. Run simulation for multiple days\n";
         cout << "4. Reset to default configuration\n";
         cout << "5. Exit\n";
+        cout << "6. Compare route alternatives (distance / difficulty / travel time)\n";
+        cout << "7. Find shortest path on partitioned map\n";
         cout << "Enter your choice: ";
 
         int choice;
@@ -476,7 +1592,7 @@ int main() {
                 cout << "Enter destination location ID: ";
                 cin >> destId;
                 
-                if (sourceId < 0 || sourceId >= numLocations || destId < 0 || destId >= numLocations) {
+                if (!isKnownLocation(sourceId) || !isKnownLocation(destId)) {
                     cout << "Invalid location ID(s). Please try again.\n";
                     break;
                 }
@@ -492,6 +1608,7 @@ int main() {
 
             case 2:
                 campus.printLocationsStatus();
+                routeCache.printStats();
                 break;
 
             case 3: {
@@ -537,6 +1654,7 @@ int main() {
 
 
                 campus.loadFromFile(BACKUP_FILE);
+                campusFile = BACKUP_FILE;
                 break;
             }
 
@@ -545,6 +1663,75 @@ int main() {
                 cout<<"All data is saved. Existing Programme.\n";
                 running = false;
                 break;
+
+            case 6: {
+                int sourceId, destId;
+                cout << "Enter source location ID: ";
+                cin >> sourceId;
+                cout << "Enter destination location ID: ";
+                cin >> destId;
+
+                if (!isKnownLocation(sourceId) || !isKnownLocation(destId)) {
+                    cout << "Invalid location ID(s). Please try again.\n";
+                    break;
+                }
+
+                vector<ParetoRoute> front = paretoFinder.findParetoFront(sourceId, destId);
+                if (front.empty()) {
+                    cout << "No path found!\n";
+                    break;
+                }
+
+                cout << "\n" << front.size() << " non-dominated route(s):\n";
+                for (int i = 0; i < front.size(); i++) {
+                    cout << "\n#" << (i + 1) << "  Distance -> " << front[i].distance
+                         << "  Difficulty -> " << front[i].difficulty
+                         << "  Travel Time -> " << front[i].travelTime << '\n';
+                    displayPath(front[i].path, &campus);
+                }
+
+                double a, b, g;
+                cout << "\nEnter distance, difficulty and travel time weights to pick a route: ";
+                cin >> a >> b >> g;
+                ParetoRoute chosen = ParetoRouteFinder::pickRoute(front, a, b, g);
+                cout << "\nChosen route: \n";
+                displayPath(chosen.path, &campus);
+                break;
+            }
+
+            case 7: {
+                int shardCount, sourceId, destId;
+                cout << "Enter number of shards: ";
+                cin >> shardCount;
+                cout << "Enter source location ID: ";
+                cin >> sourceId;
+                cout << "Enter destination location ID: ";
+                cin >> destId;
+
+                if (shardCount <= 0) {
+                    cout << "Invalid number of shards. Please try again.\n";
+                    break;
+                }
+                if (!isKnownLocation(sourceId) || !isKnownLocation(destId)) {
+                    cout << "Invalid location ID(s). Please try again.\n";
+                    break;
+                }
+
+                if (!shardedMap || shardCount != shardedCount || campus.getTopologyVersion() != shardedTopology) {
+                    shardedMap.reset(); // Stop the old shard workers before building the new partition
+                    shardedMap.reset(new ShardedCampusMap(campusFile, shardCount));
+                    shardedCount = shardCount;
+                    shardedTopology = campus.getTopologyVersion();
+                }
+                cout << "\nMap split into " << shardedMap->getShardCount() << " shard(s) with "
+                     << shardedMap->getBoundaryCount() << " boundary location(s).\n";
+
+                pair<vector<int>,double> path_cost = shardedMap->findPath(sourceId, destId);
+                cout << "\nShortest path found: \n";
+                displayPath(path_cost.first, &campus);
+                cout<<"Distance -> "<<path_cost.second<<'\n';
+                break;
+            }
                 
             default:
                 cout << "Invalid choice. Please try again.\n";